@@ -0,0 +1,48 @@
+#!/usr/bin/env python
+"""Summarize the watch's startup phase timestamps over several launches.
+
+Usage: pebble logs | tee startup.log, switch to the face a few times, then
+       python bench/startup_report.py < startup.log
+"""
+import re
+import sys
+
+PHASES = ['init', 'window_load', 'config', 'layers', 'first_frame', 'correct_frame', 'settled']
+LINE = re.compile(r'startup (\w+) (-?\d+) ms')
+
+
+def parse(lines):
+    runs = []
+    for line in lines:
+        match = LINE.search(line)
+        if not match:
+            continue
+        phase, ms = match.group(1), int(match.group(2))
+        if phase == 'init':
+            runs.append({})
+        if runs:
+            runs[-1][phase] = ms
+    return runs
+
+
+def median(values):
+    values = sorted(values)
+    mid = len(values) // 2
+    return values[mid] if len(values) % 2 else (values[mid - 1] + values[mid]) / 2.0
+
+
+def main():
+    runs = parse(sys.stdin)
+    if not runs:
+        sys.exit('no "startup <phase> <ms> ms" lines found')
+
+    print('{} launches'.format(len(runs)))
+    print('{:<14} {:>6} {:>8} {:>6}'.format('phase', 'min', 'median', 'max'))
+    for phase in PHASES:
+        values = [run[phase] for run in runs if phase in run]
+        if values:
+            print('{:<14} {:>6} {:>8.1f} {:>6}'.format(phase, min(values), median(values), max(values)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,145 @@
+//Host-side accuracy and speed check of the face trig kernel (src/c/trig.c) against sin_lookup.
+//Build & run: cc -O2 -I../src/c -o trig_bench trig_bench.c ../src/c/trig.c -lm && ./trig_bench
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "trig.h"
+
+#define TRIG_MAX_ANGLE 0x10000
+#define TRIG_MAX_RATIO 0xffff
+#define BENCH_ROUNDS 200000
+
+//Emulation of the firmware sin_lookup/cos_lookup: full quarter table of the 16 bit angle,
+//kept out of line because on the watch they are calls through the firmware jump table
+static int32_t lookup_table[TRIG_MAX_ANGLE / 4 + 1];
+static const int16_t radii[] = {144, 175, 135, 255};
+
+//-----------------------------------------------------------------------------------------------------------------------
+__attribute__((noinline)) static int32_t sin_lookup(int32_t angle)
+{
+	angle &= TRIG_MAX_ANGLE - 1;
+	int32_t quarter = TRIG_MAX_ANGLE / 4, idx = angle % (2 * quarter);
+	int32_t val = lookup_table[idx > quarter ? 2 * quarter - idx : idx];
+	return angle >= 2 * quarter ? -val : val;
+}
+//-----------------------------------------------------------------------------------------------------------------------
+__attribute__((noinline)) static int32_t cos_lookup(int32_t angle)
+{
+	return sin_lookup(angle + TRIG_MAX_ANGLE / 4);
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static double now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+//-----------------------------------------------------------------------------------------------------------------------
+//Points of one face redraw (hand + 72 ticks at dial and text radius), old code path
+static int32_t face_legacy(int32_t step)
+{
+	int32_t acc = 0, angle = TRIG_MAX_ANGLE * step / TRIG_STEPS,
+		sinl = sin_lookup(angle), cosl = cos_lookup(angle);
+	acc += (int16_t)(sinl * 144 / TRIG_MAX_RATIO) + (int16_t)(-cosl * 144 / TRIG_MAX_RATIO);
+	for (int32_t i = 1; i <= 72; i++)
+	{
+		int32_t angleC = TRIG_MAX_ANGLE * i / 72,
+			sinC = sin_lookup(angleC), cosC = cos_lookup(angleC);
+		acc += (int16_t)(sinC * 175 / TRIG_MAX_RATIO) + (int16_t)(-cosC * 175 / TRIG_MAX_RATIO);
+		acc += (int16_t)(sinC * 135 / TRIG_MAX_RATIO) + (int16_t)(-cosC * 135 / TRIG_MAX_RATIO);
+	}
+	acc += (int16_t)(sinl * 255 / TRIG_MAX_RATIO) + (int16_t)(-cosl * 255 / TRIG_MAX_RATIO);
+	return acc;
+}
+//-----------------------------------------------------------------------------------------------------------------------
+//Same points through the face trig kernel
+static int32_t face_kernel(int32_t step)
+{
+	int32_t acc = 0;
+	int16_t dx, dy;
+	trig_polar(step, 144, &dx, &dy);
+	acc += dx + dy;
+	for (int32_t i = 1; i <= 72; i++)
+	{
+		trig_tick_polar(i % TRIG_TICKS, TRIG_RAD_TICK, &dx, &dy);
+		acc += dx + dy;
+		trig_tick_polar(i % TRIG_TICKS, TRIG_RAD_TEXT, &dx, &dy);
+		acc += dx + dy;
+	}
+	trig_polar(step, 255, &dx, &dy);
+	acc += dx + dy;
+	return acc;
+}
+//-----------------------------------------------------------------------------------------------------------------------
+int main(void)
+{
+	for (int32_t i = 0; i <= TRIG_MAX_ANGLE / 4; i++)
+		lookup_table[i] = (int32_t)lround(sin(i * 2 * M_PI / TRIG_MAX_ANGLE) * TRIG_MAX_RATIO);
+
+	//Accuracy over every step and every face radius
+	double err_legacy = 0, err_kernel = 0;
+	int32_t n_diff = 0, n_total = 0;
+	for (size_t r = 0; r < sizeof(radii) / sizeof(radii[0]); r++)
+		for (int32_t step = 0; step < TRIG_STEPS; step++)
+		{
+			double exact_s = sin(step * 2 * M_PI / TRIG_STEPS) * radii[r],
+				exact_c = cos(step * 2 * M_PI / TRIG_STEPS) * radii[r];
+			int32_t angle = TRIG_MAX_ANGLE * step / TRIG_STEPS;
+			int16_t leg_s = (int16_t)(sin_lookup(angle) * radii[r] / TRIG_MAX_RATIO),
+				leg_c = (int16_t)(cos_lookup(angle) * radii[r] / TRIG_MAX_RATIO),
+				ker_s = trig_sin(step, radii[r]), ker_c = trig_cos(step, radii[r]);
+
+			err_legacy = fmax(err_legacy, fmax(fabs(leg_s - exact_s), fabs(leg_c - exact_c)));
+			err_kernel = fmax(err_kernel, fmax(fabs(ker_s - exact_s), fabs(ker_c - exact_c)));
+			int16_t pol_x, pol_y;
+			trig_polar(step, radii[r], &pol_x, &pol_y);
+			if (pol_x != ker_s || pol_y != -ker_c)
+			{
+				printf("FAIL: trig_polar disagrees with trig_sin/trig_cos at step %d\n", step);
+				return EXIT_FAILURE;
+			}
+
+			n_diff += (leg_s != ker_s) + (leg_c != ker_c);
+			n_total += 2;
+		}
+
+	//Pre-scaled tick tables must match the generic kernel
+	for (int32_t tick = 0; tick < TRIG_TICKS; tick++)
+	{
+		int16_t tx, ty, px, py;
+		trig_tick_polar(tick, TRIG_RAD_TICK, &tx, &ty);
+		trig_polar(tick * TRIG_TICK_STEPS, TRIG_RAD_TICK_PX, &px, &py);
+		int32_t bad = tx != px || ty != py;
+		trig_tick_polar(tick, TRIG_RAD_TEXT, &tx, &ty);
+		trig_polar(tick * TRIG_TICK_STEPS, TRIG_RAD_TEXT_PX, &px, &py);
+		if (bad || tx != px || ty != py)
+		{
+			printf("FAIL: tick table disagrees with trig_polar at tick %d\n", tick);
+			return EXIT_FAILURE;
+		}
+	}
+
+	printf("accuracy: max error sin_lookup %.3f px, kernel %.3f px, %d of %d points differ\n",
+		err_legacy, err_kernel, n_diff, n_total);
+	if (err_kernel > 0.51)
+	{
+		printf("FAIL: kernel error above half a pixel plus table quantization\n");
+		return EXIT_FAILURE;
+	}
+
+	//Speed of a full face redraw worth of points
+	volatile int32_t sink = 0;
+	double t0 = now_ns();
+	for (int32_t n = 0; n < BENCH_ROUNDS; n++)
+		sink += face_legacy(n % TRIG_STEPS);
+	double t1 = now_ns();
+	for (int32_t n = 0; n < BENCH_ROUNDS; n++)
+		sink += face_kernel(n % TRIG_STEPS);
+	double t2 = now_ns();
+
+	printf("speed: sin_lookup %.1f ns/face, kernel %.1f ns/face\n",
+		(t1 - t0) / BENCH_ROUNDS, (t2 - t1) / BENCH_ROUNDS);
+	return EXIT_SUCCESS;
+}
+//-----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,90 @@
+#include "complications.h"
+
+//Slot updates within this window end up in one redraw
+#define COMPL_FLUSH_MS 100
+
+static ComplSlot s_slots[COMPL_MAX_SLOTS];
+static Layer *s_layers[COMPL_MAX_SLOTS];
+static uint8_t s_count, s_dirty;
+static AppTimer *s_flush_timer;
+
+//-----------------------------------------------------------------------------------------------------------------------
+static void compl_flush(void *data)
+{
+	s_flush_timer = NULL;
+	for (uint8_t i = 0; i < s_count; i++)
+		if (s_dirty & (1 << i))
+			layer_mark_dirty(s_layers[i]);
+	s_dirty = 0;
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static void compl_defer(uint8_t mask)
+{
+	s_dirty |= mask;
+	if (s_dirty && !s_flush_timer)
+		s_flush_timer = app_timer_register(COMPL_FLUSH_MS, compl_flush, NULL);
+}
+
+//-----------------------------------------------------------------------------------------------------------------------
+ComplSlotId compl_add(const ComplSlot *slot)
+{
+	if (s_count >= COMPL_MAX_SLOTS)
+	{
+		APP_LOG(APP_LOG_LEVEL_WARNING, "No free complication slot");
+		return -1;
+	}
+	
+	s_slots[s_count] = *slot;
+	s_layers[s_count] = layer_create(slot->frame);
+	layer_set_update_proc(s_layers[s_count], slot->draw);
+	return s_count++;
+}
+//-----------------------------------------------------------------------------------------------------------------------
+Layer *compl_get_layer(ComplSlotId id)
+{
+	return id >= 0 && id < s_count ? s_layers[id] : NULL;
+}
+//-----------------------------------------------------------------------------------------------------------------------
+void compl_tick(TimeUnits units_changed)
+{
+	uint8_t mask = 0;
+	for (uint8_t i = 0; i < s_count; i++)
+		if (s_slots[i].units & units_changed)
+			mask |= 1 << i;
+	compl_defer(mask);
+}
+//-----------------------------------------------------------------------------------------------------------------------
+void compl_event(ComplEvent event)
+{
+	uint8_t mask = 0;
+	for (uint8_t i = 0; i < s_count; i++)
+		if (s_slots[i].events & event)
+			mask |= 1 << i;
+	compl_defer(mask);
+}
+//-----------------------------------------------------------------------------------------------------------------------
+void compl_mark_dirty(ComplSlotId id)
+{
+	if (id >= 0 && id < s_count)
+		compl_defer(1 << id);
+}
+//-----------------------------------------------------------------------------------------------------------------------
+void compl_window_drawn(void)
+{
+	//The whole window was just rendered, pending slots are already up to date
+	s_dirty = 0;
+	if (s_flush_timer)
+	{
+		app_timer_cancel(s_flush_timer);
+		s_flush_timer = NULL;
+	}
+}
+//-----------------------------------------------------------------------------------------------------------------------
+void compl_destroy_all(void)
+{
+	compl_window_drawn();
+	for (uint8_t i = 0; i < s_count; i++)
+		layer_destroy(s_layers[i]);
+	s_count = 0;
+}
+//-----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,37 @@
+#pragma once
+#include <pebble.h>
+
+#define COMPL_MAX_SLOTS 8
+
+//Events a slot can be refreshed on besides its tick units
+typedef enum {
+	COMPL_EVENT_NONE = 0,
+	COMPL_EVENT_BATTERY = 1 << 0,
+	COMPL_EVENT_BLUETOOTH = 1 << 1,
+	COMPL_EVENT_CONFIG = 1 << 2
+} ComplEvent;
+
+typedef struct {
+	TimeUnits units;        //Redraw when one of these units changed, 0 = events only
+	uint8_t events;         //Redraw on these ComplEvent's
+	GRect frame;            //Initial frame of the slot layer
+	LayerUpdateProc draw;   //Draws the slot into its own bounds
+} ComplSlot;
+
+typedef int8_t ComplSlotId;
+
+//Creates the slot layer, the caller adds it to the layer tree; -1 if all slots are used
+ComplSlotId compl_add(const ComplSlot *slot);
+Layer *compl_get_layer(ComplSlotId id);
+
+//Collect the slots due for the changed units / events, they are marked dirty together
+//after a short delay unless a full window redraw comes first
+void compl_tick(TimeUnits units_changed);
+void compl_event(ComplEvent event);
+void compl_mark_dirty(ComplSlotId id);
+
+//Call from an update proc that runs on every window redraw (any dirty layer re-renders
+//the whole window), drops the pending slots since they were just drawn as well
+void compl_window_drawn(void);
+
+void compl_destroy_all(void);
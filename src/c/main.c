@@ -1,4 +1,7 @@
 #include <pebble.h>
+#include "trig.h"
+#include "complications.h"
+#include "startup.h"
 	
 enum ConfigKeys {
 	CONFIG_KEY_THEME=1,
@@ -8,16 +11,26 @@ enum ConfigKeys {
 	CONFIG_KEY_SEP=5,
 	CONFIG_KEY_DATEFMT=6,
 	CONFIG_KEY_SMART=7,
-	CONFIG_KEY_VIBR=8
+	CONFIG_KEY_VIBR=8,
+	CONFIG_KEY_VERSION=9,
+	CONFIG_KEY_FAST=10,
+	CONFIG_KEY_CACHE=11
 };
 
 enum TimerKey {
 	TIMER_ANIM_FACE = 0x0001,
 	TIMER_ANIM_FACE_MS = 75,
 	TIMER_ANIM_BATT = 0x0002,
-	TIMER_ANIM_BATT_MS = 1000
+	TIMER_ANIM_BATT_MS = 1000,
+	TIMER_SEND_VERS = 0x0004,
+	TIMER_SEND_VERS_MS = 2000,
+	TIMER_ANIM_SWEEP = 0x0008,
+	TIMER_ANIM_SWEEP_MS = 75
 };
 
+//Version reports resent while the phone side JS is not ready yet
+#define SEND_VERS_TRIES_MAX 3
+
 typedef struct {
 	bool circle;
 	bool fsm;
@@ -26,9 +39,18 @@ typedef struct {
 	bool sep;
 	bool smart;
 	bool vibr;
+	bool fast;
 	uint16_t datefmt;
 } CfgDta_t;
 
+//Raw CfgDta_t blob behind CONFIG_KEY_CACHE, bump the format on any change of CfgDta_t
+#define CONFIG_CACHE_FORMAT 1
+
+typedef struct {
+	uint8_t format;
+	CfgDta_t cfg;
+} CfgCache_t;
+
 static const struct GPathInfo HAND_PATH_INFO = {
  	.num_points = 4, 
 	.points = (GPoint[]) {{-3, 0}, {-3, 222}, {3, 222}, {3, 0}}
@@ -64,16 +86,16 @@ static const VibePattern vibe_pat_bt = {
 };
 
 Window *window;
-Layer *face_layer;
-TextLayer* date_layer;
-BitmapLayer *radio_layer, *battery_layer;
+Layer *face_layer, *sweep_layer;
+Layer *date_layer, *radio_layer, *battery_layer;
 
 static GFont digitS;
 char hhBuffer[] = "00";
 char ddmmyyyyBuffer[] = "00.00.0000";
-static GBitmap *bmp_mask, *bmp_batt, *bmp_radio, *batteryAll;
-static int16_t aktHH, aktMM, aktBatt, aktBattAnim, aktBT;
-static AppTimer *timer_face, *timer_batt;
+static GBitmap *bmp_mask, *batteryAll;
+static int16_t aktHH, aktMM, aktBatt, aktBattAnim, aktBT, nVersTries, nBattImage, nSweepStep;
+static ComplSlotId slot_date, slot_radio, slot_batt;
+static AppTimer *timer_face, *timer_batt, *timer_vers, *timer_sweep;
 static bool b_initialized, b_charging;
 static CfgDta_t CfgData;
 static PropertyAnimation *s_prop_anim_date, *s_prop_anim_bt, *s_prop_anim_batt;
@@ -100,14 +122,15 @@ static void face_update_proc(Layer *layer, GContext *ctx)
 	graphics_context_set_text_color(ctx, CfgData.circle || CfgData.inv ? GColorBlack : GColorWhite);
 	graphics_context_set_fill_color(ctx, CfgData.circle || CfgData.inv ? GColorBlack : GColorWhite);
 	
-	//TRIG_MAX_ANGLE * t->tm_sec / 60
-	int32_t angle = (TRIG_MAX_ANGLE * (((aktHH % 12) * 60) + (aktMM / 1))) / (12 * 60), 
-		sinl = sin_lookup(angle), cosl = cos_lookup(angle);
-	int16_t radV = 144, radD = 175, radT = 135;
+	//One trig step per minute on the 12h dial
+	int32_t step = ((aktHH % 12) * 60) + aktMM, 
+		angle = (TRIG_MAX_ANGLE * step) / TRIG_STEPS;
+	int16_t radV = 144;
 	
 	GPoint sub_center, ptLin, ptDot;
-	sub_center.x = (int16_t)(sinl * (int32_t)radV / TRIG_MAX_RATIO) + clock_center.x;
-	sub_center.y = (int16_t)(-cosl * (int32_t)radV / TRIG_MAX_RATIO) + clock_center.y;
+	trig_polar(step, radV, &sub_center.x, &sub_center.y);
+	sub_center.x += clock_center.x;
+	sub_center.y += clock_center.y;
 
 	GRect sub_rect = {
 		.origin = GPoint(sub_center.x - bounds.size.w / 2, sub_center.y - bounds.size.h / 2),
@@ -116,11 +139,11 @@ static void face_update_proc(Layer *layer, GContext *ctx)
 
 	for (int32_t i = 1; i<=72; i++)
 	{
-		int32_t angleC = TRIG_MAX_ANGLE * i / 72,
-			sinC = sin_lookup(angleC), cosC = cos_lookup(angleC);
+		int32_t angleC = TRIG_MAX_ANGLE * i / 72;
 		
-		ptLin.x = (int16_t)(sinC * (int32_t)(radD) / TRIG_MAX_RATIO) + clock_center.x - sub_rect.origin.x;
-		ptLin.y = (int16_t)(-cosC * (int32_t)(radD) / TRIG_MAX_RATIO) + clock_center.y - sub_rect.origin.y;
+		trig_tick_polar(i % TRIG_TICKS, TRIG_RAD_TICK, &ptLin.x, &ptLin.y);
+		ptLin.x += clock_center.x - sub_rect.origin.x;
+		ptLin.y += clock_center.y - sub_rect.origin.y;
 
 		if (ptLin.x > -40 && ptLin.x < bounds.size.w+40 && ptLin.y > -40 && ptLin.y < bounds.size.h+40)
 		{
@@ -141,8 +164,9 @@ static void face_update_proc(Layer *layer, GContext *ctx)
 					fonts_get_system_font(FONT_KEY_DROID_SERIF_28_BOLD), 
 					bounds, GTextOverflowModeWordWrap, GTextAlignmentCenter);
 
-				ptDot.x = (int16_t)(sinC * (int32_t)radT / TRIG_MAX_RATIO) + clock_center.x - sub_rect.origin.x;
-				ptDot.y = (int16_t)(-cosC * (int32_t)radT / TRIG_MAX_RATIO) + clock_center.y - sub_rect.origin.y;
+				trig_tick_polar(i % TRIG_TICKS, TRIG_RAD_TEXT, &ptDot.x, &ptDot.y);
+				ptDot.x += clock_center.x - sub_rect.origin.x;
+				ptDot.y += clock_center.y - sub_rect.origin.y;
 
 				graphics_draw_text(ctx, hhBuffer, 
 					fonts_get_system_font(FONT_KEY_DROID_SERIF_28_BOLD), 
@@ -165,8 +189,9 @@ static void face_update_proc(Layer *layer, GContext *ctx)
 	}
 
 	//Draw Hand Path
-	ptLin.x = (int16_t)(sinl * (int32_t)(radV+111) / TRIG_MAX_RATIO) + clock_center.x - sub_rect.origin.x;
-	ptLin.y = (int16_t)(-cosl * (int32_t)(radV+111) / TRIG_MAX_RATIO) + clock_center.y - sub_rect.origin.y;
+	trig_polar(step, radV+111, &ptLin.x, &ptLin.y);
+	ptLin.x += clock_center.x - sub_rect.origin.x;
+	ptLin.y += clock_center.y - sub_rect.origin.y;
 	
 #ifdef PBL_COLOR
 	graphics_context_set_fill_color(ctx, GColorOrange);
@@ -213,6 +238,83 @@ static void face_update_proc(Layer *layer, GContext *ctx)
 			graphics_draw_arc(ctx, GRect(center.x-100, bounds.size.h-n_bottom_margin-5, 200, 200), GOvalScaleModeFitCircle, DEG_TO_TRIGANGLE(275), DEG_TO_TRIGANGLE(445));
 	}
 #endif
+
+	//Slots were redrawn with the face, no separate redraw needed for them
+	compl_window_drawn();
+
+	//Startup profiling, time check only until the first correct frame
+	startup_mark(STARTUP_FIRST_FRAME);
+	if (!startup_marked(STARTUP_CORRECT_FRAME))
+	{
+		time_t temp = time(NULL);
+		struct tm *t = localtime(&temp);
+		if ((aktHH % 12) == (t->tm_hour % 12) && aktMM == t->tm_min)
+			startup_mark(STARTUP_CORRECT_FRAME);
+	}
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static void sweep_update_proc(Layer *layer, GContext *ctx) 
+{
+	GRect bounds = layer_get_bounds(layer);
+	GPoint sub_center, ptLin;
+	
+	//Same geometry as the face, the dial stays at the current time and only the hand outline sweeps
+	trig_polar(((aktHH % 12) * 60) + aktMM, 144, &sub_center.x, &sub_center.y);
+	trig_polar(nSweepStep, 144+111, &ptLin.x, &ptLin.y);
+	ptLin.x += bounds.size.w / 2 - sub_center.x;
+	ptLin.y += bounds.size.h / 2 - sub_center.y;
+	
+	graphics_context_set_stroke_color(ctx, CfgData.circle || CfgData.inv ? GColorBlack : GColorWhite);
+	gpath_move_to(hand_path, ptLin);
+	gpath_rotate_to(hand_path, (TRIG_MAX_ANGLE * nSweepStep) / TRIG_STEPS);
+	gpath_draw_outline(ctx, hand_path);
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static void sweep_stop(void)
+{
+	if (sweep_layer == NULL)
+		return;
+	
+	if (timer_sweep)
+		app_timer_cancel(timer_sweep);
+	timer_sweep = NULL;
+	
+	layer_remove_from_parent(sweep_layer);
+	layer_destroy(sweep_layer);
+	sweep_layer = NULL;
+	startup_mark(STARTUP_SETTLED);
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static void date_update_proc(Layer *layer, GContext *ctx) 
+{
+	GRect bounds = layer_get_bounds(layer);
+	
+	graphics_context_set_fill_color(ctx, CfgData.inv ? GColorWhite : GColorBlack);
+	graphics_fill_rect(ctx, bounds, 0, GCornerNone);
+#ifdef PBL_COLOR
+	graphics_context_set_text_color(ctx, CfgData.inv ? GColorDarkGray : GColorLightGray);
+#else
+	graphics_context_set_text_color(ctx, CfgData.inv ? GColorBlack : GColorWhite);
+#endif
+	graphics_draw_text(ctx, ddmmyyyyBuffer, digitS, bounds, GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static void icon_draw(GContext *ctx, int16_t nImage)
+{
+	//All icons share one strip, draw it shifted and let the layer clip
+	GSize size = gbitmap_get_bounds(batteryAll).size;
+	graphics_draw_bitmap_in_rect(ctx, batteryAll, GRect(-10*nImage, 0, size.w, size.h));
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static void radio_update_proc(Layer *layer, GContext *ctx) 
+{
+	if (aktBT == 1)
+		icon_draw(ctx, 11);
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static void battery_update_proc(Layer *layer, GContext *ctx) 
+{
+	icon_draw(ctx, nBattImage);
 }
 //-----------------------------------------------------------------------------------------------------------------------
 static void handle_tick(struct tm *tick_time, TimeUnits units_changed) 
@@ -262,13 +364,24 @@ static void handle_tick(struct tm *tick_time, TimeUnits units_changed)
 	*/
 	//strcpy(ddmmyyyyBuffer, "00000");
 	
-	text_layer_set_text(date_layer, ddmmyyyyBuffer);
+	compl_tick(units_changed);
 	
 	//Hourly vibrate
 	if (CfgData.vibr && tick_time->tm_min == 0)
 		vibes_enqueue_custom_pattern(vibe_pat_hr); 	
 }
 //-----------------------------------------------------------------------------------------------------------------------
+static void send_config_version(void)
+{
+	//Phone compares it to the last acknowledged config and only resends on mismatch
+	DictionaryIterator *iter;
+	if (!bluetooth_connection_service_peek() || app_message_outbox_begin(&iter) != APP_MSG_OK)
+		return;
+	
+	dict_write_int32(iter, CONFIG_KEY_VERSION, persist_exists(CONFIG_KEY_VERSION) ? persist_read_int(CONFIG_KEY_VERSION) : 0);
+	app_message_outbox_send();
+}
+//-----------------------------------------------------------------------------------------------------------------------
 static void timerCallback(void *data) 
 {
 	if ((int)data == TIMER_ANIM_FACE && !b_initialized)
@@ -336,34 +449,55 @@ static void timerCallback(void *data)
 			timer_face = app_timer_register(TIMER_ANIM_FACE_MS, timerCallback, (void*)TIMER_ANIM_FACE);
 		}
 		else
+		{
 			b_initialized = true;
+			startup_mark(STARTUP_SETTLED);
+		}
 	}
 	else if ((int)data == TIMER_ANIM_BATT && b_charging)
 	{
-		int nImage = 10 - (aktBattAnim / 10);
-		
-		bitmap_layer_set_bitmap(battery_layer, NULL);
-		gbitmap_destroy(bmp_batt);
-		bmp_batt = gbitmap_create_as_sub_bitmap(batteryAll, GRect(10*nImage, 0, 10, 20));
-		bitmap_layer_set_bitmap(battery_layer, bmp_batt);
+		nBattImage = 10 - (aktBattAnim / 10);
+		compl_mark_dirty(slot_batt);
 
 		aktBattAnim += 10;
 		if (aktBattAnim > 100)
 			aktBattAnim = aktBatt;
 		timer_batt = app_timer_register(TIMER_ANIM_BATT_MS, timerCallback, (void*)TIMER_ANIM_BATT);
 	}
+	else if ((int)data == TIMER_ANIM_SWEEP && sweep_layer)
+	{
+		//Ease towards the current time, at least 5 minutes per frame
+		int16_t dist = ((aktHH % 12) * 60) + aktMM - nSweepStep, delta = (dist < 0 ? -dist : dist) / 4;
+		if (delta < 5)
+			delta = 5;
+		
+		timer_sweep = NULL;
+		if (dist == 0)
+			sweep_stop();
+		else
+		{
+			nSweepStep += dist > 0 ? (delta < dist ? delta : dist) : (delta < -dist ? -delta : dist);
+			layer_mark_dirty(sweep_layer);
+			timer_sweep = app_timer_register(TIMER_ANIM_SWEEP_MS, timerCallback, (void*)TIMER_ANIM_SWEEP);
+		}
+	}
+	else if ((int)data == TIMER_SEND_VERS)
+	{
+		timer_vers = NULL;
+		send_config_version();
+	}
 }
 //-----------------------------------------------------------------------------------------------------------------------
 void battery_state_service_handler(BatteryChargeState charge_state) 
 {
-	int nImage = 0;
+	nBattImage = 0;
 	aktBatt = charge_state.charge_percent;
 	
 	if (charge_state.is_charging)
 	{
 		if (!b_charging)
 		{
-			nImage = 10;
+			nBattImage = 10;
 			b_charging = true;
 			aktBattAnim = aktBatt;
 			timer_batt = app_timer_register(TIMER_ANIM_BATT_MS, timerCallback, (void*)TIMER_ANIM_BATT);
@@ -371,26 +505,42 @@ void battery_state_service_handler(BatteryChargeState charge_state)
 	}
 	else
 	{
-		nImage = 10 - (aktBatt / 10);
+		nBattImage = 10 - (aktBatt / 10);
 		b_charging = false;
 	}
 	
-	bmp_batt = gbitmap_create_as_sub_bitmap(batteryAll, GRect(10*nImage, 0, 10, 20));
-	bitmap_layer_set_bitmap(battery_layer, bmp_batt);
+	compl_event(COMPL_EVENT_BATTERY);
 }
 //-----------------------------------------------------------------------------------------------------------------------
 void bluetooth_connection_handler(bool connected)
 {
-	layer_set_hidden(bitmap_layer_get_layer(radio_layer), connected != true);
-	
 	if (!connected && aktBT == 1)
 		vibes_enqueue_custom_pattern(vibe_pat_bt); 	
 	
 	aktBT = connected;
+	compl_event(COMPL_EVENT_BLUETOOTH);
 }
 //-----------------------------------------------------------------------------------------------------------------------
-static void update_configuration(void)
+static GRect face_frame(GRect bounds)
 {
+#if defined(PBL_RECT)
+	return GRect(0, 0, bounds.size.w, CfgData.fsm ? bounds.size.h : bounds.size.h-n_bottom_margin);
+#elif defined(PBL_ROUND)
+	return GRect(0, 0, bounds.size.w, bounds.size.h);
+#endif
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static void load_configuration(void)
+{
+	//Cold start reads the cached config in one call, single keys only after a change or a new cache format
+	CfgCache_t cache;
+	if (persist_read_data(CONFIG_KEY_CACHE, &cache, sizeof(cache)) == sizeof(cache) && cache.format == CONFIG_CACHE_FORMAT)
+	{
+		CfgData = cache.cfg;
+		startup_mark(STARTUP_CONFIG);
+		return;
+	}
+	
     if (persist_exists(CONFIG_KEY_THEME))
     {
         int32_t theme = persist_read_int(CONFIG_KEY_THEME);
@@ -434,54 +584,54 @@ static void update_configuration(void)
 	else	
 		CfgData.vibr = false;
 	
-	app_log(APP_LOG_LEVEL_DEBUG, __FILE__, __LINE__, "Curr Conf: circle:%d, fsm:%d, inv:%d, anim:%d, sep:%d, datefmt:%d, smart:%d, vibr:%d",
-		CfgData.circle, CfgData.fsm, CfgData.inv, CfgData.anim, CfgData.sep, CfgData.datefmt, CfgData.smart, CfgData.vibr);
+    if (persist_exists(CONFIG_KEY_FAST))
+		CfgData.fast = persist_read_bool(CONFIG_KEY_FAST);
+	else	
+		CfgData.fast = true;
+	
+	app_log(APP_LOG_LEVEL_DEBUG, __FILE__, __LINE__, "Curr Conf: circle:%d, fsm:%d, inv:%d, anim:%d, sep:%d, datefmt:%d, smart:%d, vibr:%d, fast:%d",
+		CfgData.circle, CfgData.fsm, CfgData.inv, CfgData.anim, CfgData.sep, CfgData.datefmt, CfgData.smart, CfgData.vibr, CfgData.fast);
+	
+	cache.format = CONFIG_CACHE_FORMAT;
+	cache.cfg = CfgData;
+	persist_write_data(CONFIG_KEY_CACHE, &cache, sizeof(cache));
+	startup_mark(STARTUP_CONFIG);
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static void update_configuration(void)
+{
+	//Overlay would end up below the re-added face
+	sweep_stop();
 	
 	gbitmap_destroy(batteryAll);
 	batteryAll = gbitmap_create_with_resource(CfgData.inv ? RESOURCE_ID_IMAGE_BATTERY_INV : RESOURCE_ID_IMAGE_BATTERY);
 	
-	bitmap_layer_set_bitmap(radio_layer, NULL);
-	gbitmap_destroy(bmp_radio);
-	bmp_radio = gbitmap_create_as_sub_bitmap(batteryAll, GRect(110, 0, 10, 20));
-	bitmap_layer_set_bitmap(radio_layer, bmp_radio);
-	
 	Layer *window_layer = window_get_root_layer(window);
 	GRect bounds = layer_get_bounds(window_get_root_layer(window));
 	window_set_background_color(window, CfgData.inv ? GColorWhite : GColorBlack);
 	
 	//Face Layer first on round
 	layer_remove_from_parent(face_layer);
-	layer_destroy(face_layer);
-#if defined(PBL_RECT)
-	face_layer = layer_create(GRect(0, 0, bounds.size.w, CfgData.fsm ? bounds.size.h : bounds.size.h-n_bottom_margin));
-	layer_set_update_proc(face_layer, face_update_proc);
-#elif defined(PBL_ROUND)
-	face_layer = layer_create(GRect(0, 0, bounds.size.w, bounds.size.h));
-	layer_set_update_proc(face_layer, face_update_proc);
+	layer_set_frame(face_layer, face_frame(bounds));
+#if defined(PBL_ROUND)
 	layer_add_child(window_layer, face_layer);
 #endif		
 
 	//Bottom Layer next, then Radio and Battery
-	layer_remove_from_parent(text_layer_get_layer(date_layer));
-	layer_remove_from_parent(bitmap_layer_get_layer(radio_layer));
-	layer_remove_from_parent(bitmap_layer_get_layer(battery_layer));
+	layer_remove_from_parent(date_layer);
+	layer_remove_from_parent(radio_layer);
+	layer_remove_from_parent(battery_layer);
 #if defined(PBL_RECT)
 	if (!CfgData.fsm)
 #endif		
 	{
 #if defined(PBL_RECT)
-		layer_add_child(window_layer, text_layer_get_layer(date_layer));
-		#ifdef PBL_COLOR
-			text_layer_set_text_color(date_layer, CfgData.inv ? GColorDarkGray : GColorLightGray);
-		#else
-			text_layer_set_text_color(date_layer, CfgData.inv ? GColorBlack : GColorWhite);
-		#endif
-		text_layer_set_background_color(date_layer, CfgData.inv ? GColorWhite : GColorBlack);
+		layer_add_child(window_layer, date_layer);
 #endif		
 		if (CfgData.smart)
 		{
-			layer_add_child(window_layer, bitmap_layer_get_layer(radio_layer));
-			layer_add_child(window_layer, bitmap_layer_get_layer(battery_layer));
+			layer_add_child(window_layer, radio_layer);
+			layer_add_child(window_layer, battery_layer);
 		}
 	}	
 
@@ -506,6 +656,9 @@ static void update_configuration(void)
 	//Set Bluetooth state
 	bool connected = bluetooth_connection_service_peek();
 	bluetooth_connection_handler(connected);
+	
+	//Colors or icon strip may have changed
+	compl_event(COMPL_EVENT_CONFIG);
 }
 //-----------------------------------------------------------------------------------------------------------------------
 void in_received_handler(DictionaryIterator *received, void *ctx)
@@ -519,8 +672,11 @@ void in_received_handler(DictionaryIterator *received, void *ctx)
                 __FILE__,
                 __LINE__,
                 "KEY %d=%s", (int16_t)akt_tuple->key,
-                akt_tuple->value->cstring);
+                akt_tuple->type == TUPLE_CSTRING ? akt_tuple->value->cstring : "-");
 
+		if (akt_tuple->key == CONFIG_KEY_VERSION)
+			persist_write_int(CONFIG_KEY_VERSION, akt_tuple->value->int32);
+		
 		if (akt_tuple->key == CONFIG_KEY_THEME)
 			persist_write_int(CONFIG_KEY_THEME, 
 				strcmp(akt_tuple->value->cstring, "circle") == 0 ? 0 : 1);
@@ -557,9 +713,14 @@ void in_received_handler(DictionaryIterator *received, void *ctx)
 		if (akt_tuple->key == CONFIG_KEY_VIBR)
 			persist_write_bool(CONFIG_KEY_VIBR, strcmp(akt_tuple->value->cstring, "yes") == 0);
 		
+		if (akt_tuple->key == CONFIG_KEY_FAST)
+			persist_write_bool(CONFIG_KEY_FAST, strcmp(akt_tuple->value->cstring, "yes") == 0);
+		
 		akt_tuple = dict_read_next(received);
 	}
 	
+	persist_delete(CONFIG_KEY_CACHE);
+	load_configuration();
     update_configuration();
 }
 //-----------------------------------------------------------------------------------------------------------------------
@@ -572,52 +733,90 @@ void in_dropped_handler(AppMessageResult reason, void *ctx)
             reason);
 }
 //-----------------------------------------------------------------------------------------------------------------------
+void out_failed_handler(DictionaryIterator *failed, AppMessageResult reason, void *ctx)
+{
+	//Phone side JS is often not ready yet right after launch, no phone at all is not worth retrying
+	if (reason == APP_MSG_NOT_CONNECTED || !bluetooth_connection_service_peek())
+		return;
+	if (nVersTries++ < SEND_VERS_TRIES_MAX)
+		timer_vers = app_timer_register(TIMER_SEND_VERS_MS, timerCallback, (void*)TIMER_SEND_VERS);
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static void sweep_start(void)
+{
+	//From 12 o'clock the shorter way, like the face sweep
+	int16_t step = ((aktHH % 12) * 60) + aktMM;
+	nSweepStep = step < TRIG_STEPS / 2 ? 0 : TRIG_STEPS;
+	
+	sweep_layer = layer_create(layer_get_frame(face_layer));
+	layer_set_update_proc(sweep_layer, sweep_update_proc);
+	layer_insert_above_sibling(sweep_layer, face_layer);
+	timer_sweep = app_timer_register(TIMER_ANIM_SWEEP_MS, timerCallback, (void*)TIMER_ANIM_SWEEP);
+}
+//-----------------------------------------------------------------------------------------------------------------------
 static void window_load(Window *window) 
 {
+	startup_mark(STARTUP_WINDOW_LOAD);
+	
 	Layer *window_layer = window_get_root_layer(window);
 	GRect bounds = layer_get_bounds(window_layer);
 	
 	digitS = fonts_load_custom_font(resource_get_handle(RESOURCE_ID_FONT_DIGITAL_23));
 	bmp_mask = gbitmap_create_with_resource(RESOURCE_ID_IMAGE_MASK);
 	
+	//Final config first, so the layer tree is built only once
+	load_configuration();
+	
 	// Init layers
-	face_layer = layer_create(GRect(0, 0, bounds.size.w, bounds.size.w));
+	face_layer = layer_create(face_frame(bounds));
 	layer_set_update_proc(face_layer, face_update_proc);
 
-	date_layer = text_layer_create(GRect(-bounds.size.w, bounds.size.h-n_bottom_margin-2, bounds.size.w, n_bottom_margin));
-	text_layer_set_text_alignment(date_layer, GTextAlignmentCenter);
-	text_layer_set_font(date_layer, digitS);
+	//Init complication slots: date, bluetooth radio, battery
+	slot_date = compl_add(&(ComplSlot) {
+		.units = DAY_UNIT,
+		.events = COMPL_EVENT_CONFIG,
+		.frame = GRect(-bounds.size.w, bounds.size.h-n_bottom_margin-2, bounds.size.w, n_bottom_margin),
+		.draw = date_update_proc
+	});
+	date_layer = compl_get_layer(slot_date);
 
-	//Init bluetooth radio
-	radio_layer = bitmap_layer_create(GRect(1, bounds.size.h, 10, 20));
-	bitmap_layer_set_background_color(radio_layer, GColorClear);
+	slot_radio = compl_add(&(ComplSlot) {
+		.events = COMPL_EVENT_BLUETOOTH | COMPL_EVENT_CONFIG,
+		.frame = GRect(1, bounds.size.h, 10, 20),
+		.draw = radio_update_proc
+	});
+	radio_layer = compl_get_layer(slot_radio);
 		
-	//Init battery
-	battery_layer = bitmap_layer_create(GRect(bounds.size.w-11, bounds.size.h, 10, 20)); 
-	bitmap_layer_set_background_color(battery_layer, GColorClear);
+	slot_batt = compl_add(&(ComplSlot) {
+		.events = COMPL_EVENT_BATTERY | COMPL_EVENT_CONFIG,
+		.frame = GRect(bounds.size.w-11, bounds.size.h, 10, 20),
+		.draw = battery_update_proc
+	});
+	battery_layer = compl_get_layer(slot_batt);
 
 	//Update Configuration
 	update_configuration();
+	startup_mark(STARTUP_LAYERS);
 	
-	//Start|Skip Animation
-	if (CfgData.anim)
+	//Start|Skip Animation, fast start shows the final layout right away
+	if (CfgData.anim && !CfgData.fast)
 	{
 		aktHH = aktMM = 0;
 		timer_face = app_timer_register(500, timerCallback, (void*)TIMER_ANIM_FACE);
 		
 		//Animate Date
-		GRect rc_from = layer_get_frame(text_layer_get_layer(date_layer));
+		GRect rc_from = layer_get_frame(date_layer);
 		GRect rc_to = rc_from;
 		rc_to.origin.x = 0;
 
-		s_prop_anim_date = property_animation_create_layer_frame(text_layer_get_layer(date_layer), &rc_from, &rc_to);
+		s_prop_anim_date = property_animation_create_layer_frame(date_layer, &rc_from, &rc_to);
 		animation_set_curve((Animation*)s_prop_anim_date, AnimationCurveEaseOut);
 		animation_set_delay((Animation*)s_prop_anim_date, 500);
 		animation_set_duration((Animation*)s_prop_anim_date, 1000);
 		animation_schedule((Animation*)s_prop_anim_date);
 		
 		//Animate Bluetooth
-		rc_from = layer_get_frame(bitmap_layer_get_layer(radio_layer));
+		rc_from = layer_get_frame(radio_layer);
 #if defined(PBL_RECT)
 		rc_to = rc_from;
 		rc_to.origin.y -= rc_from.size.h+1;
@@ -626,14 +825,14 @@ static void window_load(Window *window)
 		rc_to = rc_from;
 		rc_to.origin.x = 4;
 #endif		
-		s_prop_anim_bt = property_animation_create_layer_frame(bitmap_layer_get_layer(radio_layer), &rc_from, &rc_to);
+		s_prop_anim_bt = property_animation_create_layer_frame(radio_layer, &rc_from, &rc_to);
 		animation_set_curve((Animation*)s_prop_anim_bt, AnimationCurveEaseOut);
 		animation_set_delay((Animation*)s_prop_anim_bt, 1500);
 		animation_set_duration((Animation*)s_prop_anim_bt, 1000);
 		animation_schedule((Animation*)s_prop_anim_bt);
 		
 		//Animate Battery
-		rc_from = layer_get_frame(bitmap_layer_get_layer(battery_layer));
+		rc_from = layer_get_frame(battery_layer);
 #if defined(PBL_RECT)
 		rc_to = rc_from;
 		rc_to.origin.y -= rc_from.size.h+1;
@@ -642,7 +841,7 @@ static void window_load(Window *window)
 		rc_to = rc_from;
 		rc_to.origin.x = bounds.size.w-rc_from.size.w-4;
 #endif		
-		s_prop_anim_batt = property_animation_create_layer_frame(bitmap_layer_get_layer(battery_layer), &rc_from, &rc_to);
+		s_prop_anim_batt = property_animation_create_layer_frame(battery_layer, &rc_from, &rc_to);
 		animation_set_curve((Animation*)s_prop_anim_batt, AnimationCurveEaseOut);
 		animation_set_delay((Animation*)s_prop_anim_batt, 2000);
 		animation_set_duration((Animation*)s_prop_anim_batt, 1000);
@@ -650,39 +849,42 @@ static void window_load(Window *window)
 	}	
 	else
 	{	
-		GRect rc = layer_get_frame(text_layer_get_layer(date_layer));
+		GRect rc = layer_get_frame(date_layer);
 		rc.origin.x = 0;
-		layer_set_frame(text_layer_get_layer(date_layer), rc);
+		layer_set_frame(date_layer, rc);
 		
-		rc = layer_get_frame(bitmap_layer_get_layer(radio_layer));
+		rc = layer_get_frame(radio_layer);
 #if defined(PBL_RECT)
 		rc.origin.y -= rc.size.h+1;
 #elif defined(PBL_ROUND)
 		rc = GRect(4, bounds.size.h/2-rc.size.h/2, rc.size.w, rc.size.h);
 #endif		
-		layer_set_frame(bitmap_layer_get_layer(radio_layer), rc);
+		layer_set_frame(radio_layer, rc);
 		
-		rc = layer_get_frame(bitmap_layer_get_layer(battery_layer));
+		rc = layer_get_frame(battery_layer);
 #if defined(PBL_RECT)
 		rc.origin.y -= rc.size.h+1;
 #elif defined(PBL_ROUND)
 		rc = GRect(bounds.size.w-rc.size.w-4, bounds.size.h/2-rc.size.h/2, rc.size.w, rc.size.h);
 #endif		
-		layer_set_frame(bitmap_layer_get_layer(battery_layer), rc);
+		layer_set_frame(battery_layer, rc);
 		
 		b_initialized = true;
+		
+		//Face is correct already, the sweep only runs as an overlay
+		if (CfgData.anim)
+			sweep_start();
+		else
+			startup_mark(STARTUP_SETTLED);
 	}
 }
 //-----------------------------------------------------------------------------------------------------------------------
 static void window_unload(Window *window) 
 {
+	sweep_stop();
 	layer_destroy(face_layer);
-	text_layer_destroy(date_layer);
-	bitmap_layer_destroy(battery_layer);
-	bitmap_layer_destroy(radio_layer);
+	compl_destroy_all();
 	fonts_unload_custom_font(digitS);
-	gbitmap_destroy(bmp_batt);
-	gbitmap_destroy(bmp_radio);
 	gbitmap_destroy(bmp_mask);
 	gbitmap_destroy(batteryAll);
 	
@@ -694,9 +896,12 @@ static void window_unload(Window *window)
 //-----------------------------------------------------------------------------------------------------------------------
 static void init(void) 
 {
+	startup_mark(STARTUP_INIT);
+	
 	b_initialized = false;
 	b_charging = false;
 	aktBT = -1;
+	nVersTries = 0;
 
 	char* sLocale = setlocale(LC_TIME, ""), sLang[3];
 	if (strncmp(sLocale, "en", 2) == 0)
@@ -734,12 +939,19 @@ static void init(void)
 	//Subscribe messages
 	app_message_register_inbox_received(in_received_handler);
     app_message_register_inbox_dropped(in_dropped_handler);
+    app_message_register_outbox_failed(out_failed_handler);
     app_message_open(128, 128);
+	
+	//Report config version, phone only syncs if it differs. Off the startup path,
+	//the phone side JS is not ready that early anyway
+	timer_vers = app_timer_register(TIMER_SEND_VERS_MS, timerCallback, (void*)TIMER_SEND_VERS);
 }
 //-----------------------------------------------------------------------------------------------------------------------
 static void deinit(void) 
 {
 	animation_unschedule_all();
+	if (timer_vers)
+		app_timer_cancel(timer_vers);
 	
 	app_message_deregister_callbacks();
 	tick_timer_service_unsubscribe();
@@ -0,0 +1,34 @@
+#include "startup.h"
+
+static const char *PHASE_NAMES[STARTUP_PHASES] = {
+	"init", "window_load", "config", "layers", "first_frame", "correct_frame", "settled"
+};
+
+static time_t t0_sec;
+static uint16_t t0_ms;
+static bool phase_set[STARTUP_PHASES];
+
+//-----------------------------------------------------------------------------------------------------------------------
+void startup_mark(StartupPhase phase)
+{
+	if (phase >= STARTUP_PHASES || phase_set[phase])
+		return;
+	
+	time_t sec;
+	uint16_t ms = time_ms(&sec, NULL);
+	if (phase == STARTUP_INIT)
+	{
+		t0_sec = sec;
+		t0_ms = ms;
+	}
+	
+	int32_t elapsed = (int32_t)(sec - t0_sec) * 1000 + ms - t0_ms;
+	phase_set[phase] = true;
+	APP_LOG(APP_LOG_LEVEL_INFO, "startup %s %d ms", PHASE_NAMES[phase], (int)elapsed);
+}
+//-----------------------------------------------------------------------------------------------------------------------
+bool startup_marked(StartupPhase phase)
+{
+	return phase < STARTUP_PHASES && phase_set[phase];
+}
+//-----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,18 @@
+#pragma once
+#include <pebble.h>
+
+//Cold start phases, logged as "startup <phase> <ms> ms" relative to STARTUP_INIT
+typedef enum {
+	STARTUP_INIT = 0,
+	STARTUP_WINDOW_LOAD,
+	STARTUP_CONFIG,
+	STARTUP_LAYERS,
+	STARTUP_FIRST_FRAME,
+	STARTUP_CORRECT_FRAME,
+	STARTUP_SETTLED,
+	STARTUP_PHASES
+} StartupPhase;
+
+//Records the phase once, later calls for the same phase are ignored
+void startup_mark(StartupPhase phase);
+bool startup_marked(StartupPhase phase);
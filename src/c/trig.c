@@ -0,0 +1,82 @@
+#include <stdbool.h>
+#include "trig.h"
+
+//round(sin(k * 90deg / TRIG_QUARTER) * 32768), k = 0..TRIG_QUARTER
+static const uint16_t QUARTER_WAVE[TRIG_QUARTER + 1] = {
+	    0,   286,   572,   858,  1144,  1429,  1715,  2000,  2286,  2571,
+	 2856,  3141,  3425,  3709,  3993,  4277,  4560,  4843,  5126,  5408,
+	 5690,  5971,  6252,  6533,  6813,  7092,  7371,  7650,  7927,  8204,
+	 8481,  8757,  9032,  9307,  9580,  9854, 10126, 10397, 10668, 10938,
+	11207, 11476, 11743, 12010, 12275, 12540, 12803, 13066, 13328, 13589,
+	13848, 14107, 14365, 14621, 14876, 15131, 15384, 15636, 15886, 16136,
+	16384, 16631, 16877, 17121, 17364, 17606, 17847, 18086, 18324, 18560,
+	18795, 19028, 19261, 19491, 19720, 19948, 20174, 20399, 20622, 20843,
+	21063, 21281, 21498, 21713, 21926, 22138, 22348, 22556, 22763, 22967,
+	23170, 23372, 23571, 23769, 23965, 24159, 24351, 24542, 24730, 24917,
+	25102, 25285, 25466, 25645, 25822, 25997, 26170, 26341, 26510, 26677,
+	26842, 27005, 27166, 27325, 27482, 27636, 27789, 27939, 28088, 28234,
+	28378, 28520, 28660, 28797, 28932, 29066, 29197, 29325, 29452, 29576,
+	29698, 29818, 29935, 30050, 30163, 30274, 30382, 30488, 30592, 30693,
+	30792, 30888, 30983, 31075, 31164, 31251, 31336, 31419, 31499, 31576,
+	31651, 31724, 31795, 31863, 31928, 31991, 32052, 32110, 32166, 32219,
+	32270, 32319, 32365, 32408, 32449, 32488, 32524, 32557, 32588, 32617,
+	32643, 32667, 32688, 32707, 32723, 32737, 32748, 32757, 32763, 32767,
+	32768
+};
+
+//QUARTER_WAVE at every dial tick, scaled to the dial radii
+const uint8_t TRIG_TICK_WAVE[TRIG_RAD_COUNT][TRIG_TICKS / 4 + 1] = {
+	{  0,  15,  30,  45,  60,  74,  88, 100, 112, 124, 134, 143, 152, 159, 164, 169, 172, 174, 175},
+	{  0,  12,  23,  35,  46,  57,  68,  77,  87,  95, 103, 111, 117, 122, 127, 130, 133, 134, 135}
+};
+
+//-----------------------------------------------------------------------------------------------------------------------
+static inline int32_t trig_wrap(int32_t step)
+{
+	//Face steps are almost always in range, avoid the division
+	while (step >= TRIG_STEPS)
+		step -= TRIG_STEPS;
+	while (step < 0)
+		step += TRIG_STEPS;
+	return step;
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static inline int16_t trig_quarter(int32_t idx, int16_t radius)
+{
+	return (int16_t)(((uint32_t)QUARTER_WAVE[idx] * (uint32_t)radius + (1 << 14)) >> 15);
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static int16_t trig_scale(int32_t step, int16_t radius)
+{
+	step = trig_wrap(step);
+
+	//Second half is the mirrored first half, second quarter the mirrored first quarter
+	bool neg = step >= 2 * TRIG_QUARTER;
+	if (neg)
+		step -= 2 * TRIG_QUARTER;
+	if (step > TRIG_QUARTER)
+		step = 2 * TRIG_QUARTER - step;
+
+	int16_t val = trig_quarter(step, radius);
+	return neg ? -val : val;
+}
+//-----------------------------------------------------------------------------------------------------------------------
+int16_t trig_sin(int32_t step, int16_t radius)
+{
+	return trig_scale(step, radius);
+}
+//-----------------------------------------------------------------------------------------------------------------------
+int16_t trig_cos(int32_t step, int16_t radius)
+{
+	return trig_scale(step + TRIG_QUARTER, radius);
+}
+//-----------------------------------------------------------------------------------------------------------------------
+void trig_polar(int32_t step, int16_t radius, int16_t *dx, int16_t *dy)
+{
+	step = trig_wrap(step);
+
+	//Within a quarter sin and cos are the same table read from both ends
+	int32_t quad = step / TRIG_QUARTER, idx = step - quad * TRIG_QUARTER;
+	trig_rotate(quad, trig_quarter(idx, radius), trig_quarter(TRIG_QUARTER - idx, radius), dx, dy);
+}
+//-----------------------------------------------------------------------------------------------------------------------
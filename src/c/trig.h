@@ -0,0 +1,50 @@
+#pragma once
+#include <stdint.h>
+
+//Angular resolution of the face: one step per minute on the 12h dial
+#define TRIG_STEPS 720
+#define TRIG_QUARTER (TRIG_STEPS / 4)
+
+//Steps between two of the 72 dial ticks
+#define TRIG_TICKS 72
+#define TRIG_TICK_STEPS (TRIG_STEPS / TRIG_TICKS)
+
+//Dial radii with pre-scaled tick tables
+#define TRIG_RAD_TICK_PX 175
+#define TRIG_RAD_TEXT_PX 135
+
+typedef enum {
+	TRIG_RAD_TICK = 0,
+	TRIG_RAD_TEXT = 1,
+	TRIG_RAD_COUNT
+} TrigRadius;
+
+//sin/cos of step/TRIG_STEPS of a turn, already scaled by radius (rounded to pixels)
+int16_t trig_sin(int32_t step, int16_t radius);
+int16_t trig_cos(int32_t step, int16_t radius);
+
+//Screen offset of the dial point at step and radius (clockwise from 12 o'clock, y down)
+void trig_polar(int32_t step, int16_t radius, int16_t *dx, int16_t *dy);
+
+//Quarter wave at every dial tick, pre-scaled to the dial radii
+extern const uint8_t TRIG_TICK_WAVE[TRIG_RAD_COUNT][TRIG_TICKS / 4 + 1];
+
+//Place a = |sin|, b = |cos| of an angle within its quarter into quadrant quad
+static inline void trig_rotate(int32_t quad, int16_t a, int16_t b, int16_t *dx, int16_t *dy)
+{
+	switch (quad)
+	{
+		case 0: *dx = a; *dy = -b; break;
+		case 1: *dx = b; *dy = a; break;
+		case 2: *dx = -a; *dy = b; break;
+		default: *dx = -b; *dy = -a; break;
+	}
+}
+
+//Like trig_polar for dial tick 0..TRIG_TICKS-1 at one of the dial radii, table read only
+static inline void trig_tick_polar(int32_t tick, TrigRadius rad, int16_t *dx, int16_t *dy)
+{
+	const uint8_t *wave = TRIG_TICK_WAVE[rad];
+	int32_t quad = tick / (TRIG_TICKS / 4), idx = tick - quad * (TRIG_TICKS / 4);
+	trig_rotate(quad, wave[idx], wave[TRIG_TICKS / 4 - idx], dx, dy);
+}
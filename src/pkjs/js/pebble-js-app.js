@@ -1,37 +1,127 @@
 var initialised = false;
 
+// Last state the watch acknowledged, and its version
+var ACKED_KEY = 'fuz_ana_ack';
+var VERSION_KEY = 'fuz_ana_ver';
+
+// Resend on nack after 1s, 2s, 4s, ...
+var RETRY_MS = 1000;
+var RETRY_MAX = 5;
+
+var pending = {};
+var inFlight = null;
+var retries = 0;
+var retryTimer = null;
+
+function loadObject(key) {
+    try {
+        return JSON.parse(localStorage.getItem(key)) || {};
+    } catch (ex) {
+        return {};
+    }
+}
+
+function ackedVersion() {
+    return parseInt(localStorage.getItem(VERSION_KEY), 10) || 0;
+}
+
+function queueOptions(options, full) {
+    // Only keys that differ from what the watch has or is about to get, merged into the next batch
+    var acked = full ? {} : loadObject(ACKED_KEY);
+    for (var sent in inFlight) {
+        acked[sent] = inFlight[sent];
+    }
+    for (var key in options) {
+        if (options.hasOwnProperty(key) && (acked[key] !== options[key] || pending.hasOwnProperty(key))) {
+            pending[key] = options[key];
+        }
+    }
+}
+
+function flushOptions() {
+    if (inFlight !== null || retryTimer !== null || Object.keys(pending).length === 0) {
+        return;
+    }
+
+    inFlight = pending;
+    pending = {};
+
+    var message = { 'version': ackedVersion() + 1 };
+    for (var key in inFlight) {
+        message[key] = inFlight[key];
+    }
+    console.log("sending options: " + JSON.stringify(message));
+    Pebble.sendAppMessage(message, appMessageAck, appMessageNack);
+}
+
 function appMessageAck(e) {
     console.log("options sent to Pebble successfully");
+
+    var acked = loadObject(ACKED_KEY);
+    for (var key in inFlight) {
+        acked[key] = inFlight[key];
+    }
+    localStorage.setItem(ACKED_KEY, JSON.stringify(acked));
+    localStorage.setItem(VERSION_KEY, ackedVersion() + 1);
+
+    inFlight = null;
+    retries = 0;
+    flushOptions();
 }
 
 function appMessageNack(e) {
-    console.log("options not sent to Pebble: " + e.error.message);
+    console.log("options not sent to Pebble: " + (e.error ? e.error.message : 'nack'));
+
+    // Put the batch back, newer pending values win
+    for (var key in inFlight) {
+        if (!pending.hasOwnProperty(key)) {
+            pending[key] = inFlight[key];
+        }
+    }
+    inFlight = null;
+
+    if (retries < RETRY_MAX) {
+        var delay = RETRY_MS << retries;
+        retries++;
+        retryTimer = setTimeout(function() {
+            retryTimer = null;
+            flushOptions();
+        }, delay);
+    } else {
+        console.log("giving up, options are resent on the next config change or watch start");
+        retries = 0;
+    }
 }
 
 Pebble.addEventListener("ready", function() {
     initialised = true;
 });
 
+Pebble.addEventListener("appmessage", function(e) {
+    // Watch reports its config version on start, only resync if it differs
+    if (e.payload.version === undefined) {
+        return;
+    }
+    console.log("watch config version " + e.payload.version + ", phone " + ackedVersion());
+    if (e.payload.version !== ackedVersion()) {
+        var options = JSON.parse(localStorage.getItem('fuz_ana_opt'));
+        if (options !== null) {
+            queueOptions(options, true);
+        }
+    }
+    flushOptions();
+});
+
 Pebble.addEventListener("showConfiguration", function() {
-    var options = JSON.parse(localStorage.getItem('fuz_ana_opt'));
+    var options = JSON.parse(localStorage.getItem('fuz_ana_opt')) || {};
     console.log("read options: " + JSON.stringify(options));
     console.log("showing configuration");
 
-	var chalk = Pebble.getActiveWatchInfo && Pebble.getActiveWatchInfo().platform === "chalk" ? 'yes' : 'no';
-	var uri = 'http://panicman.github.io/config_fuzana.html?title=Fuzzy%20Analog%20v3.3&chalk='+chalk;
-
-	if (options !== null) {
-        uri +=
-			'&theme=' + encodeURIComponent(options.theme) + 
-			'&fsm=' + encodeURIComponent(options.fsm) + 
-			'&inv=' + encodeURIComponent(options.inv) + 
-			'&anim=' + encodeURIComponent(options.anim) + 
-			'&sep=' + encodeURIComponent(options.sep) +
-			'&datefmt=' + encodeURIComponent(options.datefmt) + 
-			'&smart=' + encodeURIComponent(options.smart) + 
-			'&vibr=' + encodeURIComponent(options.vibr);
-    }
-	console.log("Uri: "+uri);
+	// Page is embedded by the build (config_fuzana.html), current options are injected instead of a query string
+	options.title = 'Fuzzy Analog v3.3';
+	var uri = CONFIG_PAGE_URI.replace('__FUZANA_OPTIONS__', encodeURIComponent(JSON.stringify(options)));
+
+	console.log("Uri length: " + uri.length);
     Pebble.openURL(uri);
 });
 
@@ -41,8 +131,10 @@ Pebble.addEventListener("webviewclosed", function(e) {
         var options = JSON.parse(decodeURIComponent(e.response));
         console.log("storing options: " + JSON.stringify(options));
         localStorage.setItem('fuz_ana_opt', JSON.stringify(options));
-        Pebble.sendAppMessage(options, appMessageAck, appMessageNack);
+        queueOptions(options, false);
+        flushOptions();
     } else {
         console.log("no options received");
     }
 });
+